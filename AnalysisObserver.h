@@ -0,0 +1,150 @@
+#ifndef _ANALYSISOBSERVER_H
+#define _ANALYSISOBSERVER_H
+
+#include <vector>
+#include <ostream>
+#include <mutex>
+#include <chrono>
+#include <cstddef>	// for size_t
+
+#include "PointBoard.h"
+#include "FieldStats.h"
+
+
+// An AnalysisObserver gets told what a StrongPointAnalysis is doing, for profiling and monitoring.
+// An analysis without an observer reports nothing, and doesn't time anything either.
+//
+// Every report says which sub-clustering level it is for: 0 for the board that was loaded,
+// 1 for the boards of its sub-clusters, and so on.
+// With parallel sub-clustering (the default), the reports for different clusters come from
+// several threads at once, in no particular order, so an observer must be thread-safe.
+// The default for each report is to ignore it.
+class AnalysisObserver
+{
+	public:
+		enum Phase { LOAD = 0, STATS, NETWORKING, PADDING, SUBCLUSTERING };
+		static const size_t PHASE_COUNT = SUBCLUSTERING + 1;
+
+		virtual ~AnalysisObserver();
+
+		// How long a phase took for a board.  The SUBCLUSTERING time includes all of the
+		// phases of the levels below it.
+		virtual void PhaseTimed(const int &level, const Phase &aPhase, const double &seconds);
+
+		// The statistics and thresholds of a board.  An unusable board (too few points,
+		// or no variation) gets reset, and won't find any clusters.
+		virtual void BoardAnalyzed(const int &level, const FieldStats &boardStats,
+					   const float &strongThreshold, const float &weakThreshold, const float &weakAssist,
+					   const bool &isUsable);
+
+		// How many points of a board ended up with the label, once its clusters were padded.
+		virtual void PointsLabeled(const int &level, const PointBoard::PointLabel &aLabel, const size_t &pointCount);
+
+		// What sub-clustering did with a cluster: subClusterCount is 1 if it was left as it was.
+		virtual void ClusterSubClustered(const int &level, const size_t &clustIndex,
+						 const size_t &memberCount, const size_t &subClusterCount);
+
+		// How many clusters a board found, before and after sub-clustering.
+		virtual void ClustersFound(const int &level, const size_t &preSubClusterCount, const size_t &postSubClusterCount);
+};
+
+
+// Reports how long it was around for as a phase, if there is an observer.
+class PhaseTimer
+{
+	public:
+		PhaseTimer(AnalysisObserver *theObserver, const int &level, const AnalysisObserver::Phase &aPhase)
+			:	myObserver(theObserver),
+				myLevel(level),
+				myPhase(aPhase),
+				myStartTime(theObserver != NULL ? chrono::steady_clock::now() : chrono::steady_clock::time_point())
+		{
+		};
+
+		~PhaseTimer()
+		{
+			if (myObserver != NULL)
+			{
+				myObserver->PhaseTimed(myLevel, myPhase,
+						       chrono::duration<double>(chrono::steady_clock::now() - myStartTime).count());
+			}
+		};
+
+	private:
+		AnalysisObserver *myObserver;
+		int myLevel;
+		AnalysisObserver::Phase myPhase;
+		chrono::steady_clock::time_point myStartTime;
+
+		PhaseTimer(const PhaseTimer &timerCopy);		// not copyable
+		PhaseTimer& operator = (const PhaseTimer &timerCopy);
+};
+
+
+// Adds up the reports, for all of the analyses that it observes.
+class AnalysisMetrics : public AnalysisObserver
+{
+	public:
+		AnalysisMetrics();
+
+		void Clear();
+
+		// Summed over all of the boards at the level.
+		double PhaseSeconds(const Phase &aPhase, const int &level) const;
+
+		// Summed over all of the boards at every level.
+		size_t PointCount(const PointBoard::PointLabel &aLabel) const;
+
+		// The deepest sub-clustering level that had a board, or -1 if there were no boards.
+		int DeepestLevel() const;
+
+		// Summed over all of the boards at the level.  The clusters of level 0 after
+		// sub-clustering are the clusters that DoCluster() gave back.
+		size_t BoardCount(const int &level) const;
+		size_t PreSubClusterCount(const int &level) const;
+		size_t PostSubClusterCount(const int &level) const;
+
+		void PhaseTimed(const int &level, const Phase &aPhase, const double &seconds);
+		void PointsLabeled(const int &level, const PointBoard::PointLabel &aLabel, const size_t &pointCount);
+		void ClustersFound(const int &level, const size_t &preSubClusterCount, const size_t &postSubClusterCount);
+
+	private:
+		struct LevelMetrics
+		{
+			LevelMetrics();
+
+			double phaseSeconds[PHASE_COUNT];
+			size_t boardCount;
+			size_t preSubClusterCount;
+			size_t postSubClusterCount;
+		};
+
+		mutable mutex myLock;
+		vector<LevelMetrics> myLevels;
+		size_t myPointCounts[PointBoard::STRONG + 1];
+
+		LevelMetrics& Level(const int &level);
+};
+
+
+// Writes each report as a line of text, indented by its level.
+class StreamObserver : public AnalysisObserver
+{
+	public:
+		explicit StreamObserver(ostream &theStream);
+
+		void PhaseTimed(const int &level, const Phase &aPhase, const double &seconds);
+		void BoardAnalyzed(const int &level, const FieldStats &boardStats,
+				   const float &strongThreshold, const float &weakThreshold, const float &weakAssist,
+				   const bool &isUsable);
+		void PointsLabeled(const int &level, const PointBoard::PointLabel &aLabel, const size_t &pointCount);
+		void ClusterSubClustered(const int &level, const size_t &clustIndex,
+					 const size_t &memberCount, const size_t &subClusterCount);
+		void ClustersFound(const int &level, const size_t &preSubClusterCount, const size_t &postSubClusterCount);
+
+	private:
+		mutex myLock;
+		ostream &myStream;
+};
+
+#endif
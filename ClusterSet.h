@@ -0,0 +1,76 @@
+#ifndef _CLUSTERSET_H
+#define _CLUSTERSET_H
+
+#include <vector>
+#include <cstddef>	// for size_t
+#include <stdint.h>	// for uint32_t, int32_t
+
+#include "Cluster.h"
+
+
+// A compact set of clusters, laid out like a CSR (compressed sparse row) matrix.
+// The members of cluster i are at [offsets[i], offsets[i + 1]) of XLocs, YLocs and memberVals,
+// so offsets always has one more entry than there are clusters.
+// Unlike vector<Cluster>, this is a handful of flat arrays, which makes it cheap to
+// hand over to other languages and cheap to re-use.
+class ClusterSet
+{
+	public:
+		ClusterSet();
+
+		// Locations are kept in 32 bits, so no domain can be wider or taller than this.
+		static const size_t MAX_DOMAIN_SIZE;
+
+		vector<size_t> offsets;
+		vector<uint32_t> XLocs;
+		vector<uint32_t> YLocs;
+		vector<float> memberVals;
+
+		// Empties the set, but keeps the memory around for re-use.
+		void Clear();
+
+		size_t ClusterCount() const
+		{
+			return(offsets.size() - 1);
+		};
+
+		size_t MemberCount() const
+		{
+			return(offsets.back());
+		};
+
+		size_t ClusterSize(const size_t &clustIndex) const
+		{
+			return(offsets[clustIndex + 1] - offsets[clustIndex]);
+		};
+
+		// Members always go into the most recently started cluster.
+		void StartCluster();
+		void AddMember(const size_t &newX, const size_t &newY, const float &newVal)
+		{
+			XLocs.push_back((uint32_t) newX);
+			YLocs.push_back((uint32_t) newY);
+			memberVals.push_back(newVal);
+			offsets.back()++;
+		};
+
+		// Takes back the most recently started cluster if nothing was added to it.
+		void EndCluster();
+
+		// Copies cluster clustIndex of aSet onto the end of this set.
+		void AppendCluster(const ClusterSet &aSet, const size_t &clustIndex);
+
+		// Copies all of aSet onto the end of this set, shifting every member by (xShift, yShift).
+		void Append(const ClusterSet &aSet, const size_t &xShift, const size_t &yShift);
+
+		Cluster GetCluster(const size_t &clustIndex) const;
+		vector<Cluster> ToClusters() const;
+
+		// Fills a row-major label image of the domain, where each gridpoint gets the number
+		// of the cluster that it belongs to (starting at 1), or 0 if it isn't in any cluster.
+		// A gridpoint in more than one cluster gets the lowest cluster number.
+		void FillLabelImage(int32_t *labelImage, const size_t &xSize, const size_t &ySize,
+				    const size_t &rowStride) const;
+};
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef _FIELDSTATS_H
+#define _FIELDSTATS_H
+
+#include <cstddef>	// for size_t
+
+
+// Summary statistics of a set of data values: count, min, max, mean and the sum of
+// squared deviations from the mean (M2), from which the variance follows.
+// Partial statistics of separate pieces of a field can be combined together
+// without losing precision, using the pairwise update of Chan, Golub and LeVeque.
+struct FieldStats
+{
+	size_t count;
+	double mean;
+	double M2;
+	float minVal;
+	float maxVal;
+
+	// The values are accumulated a block of BLOCK_SIZE values at a time, in order.
+	// So, accumulating each block separately and then combining the blocks in the same order
+	// comes out exactly the same as accumulating all of the values at once.
+	static const size_t BLOCK_SIZE;
+
+	FieldStats();
+
+	// Adds in the values whose mask entry is nonzero.
+	void Accumulate(const float *values, const unsigned char *mask, const size_t &valueCount);
+
+	// Adds in the values that are finite.
+	void AccumulateFinite(const float *values, const size_t &valueCount);
+
+	void Combine(const FieldStats &otherStats);
+
+	// The sample standard deviation.  Not finite for less than two values.
+	double StdDeviation() const;
+};
+
+#endif
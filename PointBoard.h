@@ -0,0 +1,177 @@
+#ifndef _POINTBOARD_H
+#define _POINTBOARD_H
+
+#include <vector>
+#include <unordered_map>
+#include <cstddef>	// for size_t
+
+#include "FieldStats.h"
+#include "Cluster.h"
+#include "ClusterSet.h"
+
+
+// The PointBoard holds the data values and the point labels used by StrongPointAnalysis.
+// Everything on the board is addressed by "slots".  Slots are always in row-major order,
+// so scanning the slots from first to last is the same as scanning the grid by rows.
+//
+// There are two storage backends, chosen by Load() from how much of the grid gets filled:
+//   DENSE  -- one slot for every gridpoint, in a single contiguous row-major array.
+//             slot = (yLoc * rowPitch) + xLoc
+//             The row pitch is the xSize, except for a raster that has a longer row stride.
+//   SPARSE -- one slot for each gridpoint that was actually loaded.  A hash table maps
+//             a gridpoint to its slot.  Gridpoints without a slot are uninitialized.
+//
+// A dense board loaded from a raster does not copy the values, unless the rows of the raster
+// are much longer than the domain.  It reads them straight out of the caller's raster,
+// which must then stay around for as long as the board is in use.
+class PointBoard
+{
+	public:
+		enum PointLabel { UNINIT = 0, UNCHECKED, IGNORABLE, WEAK, STRONG };
+
+		// Returned by FindSlot() for gridpoints that have no storage on the board.
+		static const size_t NO_SLOT;
+
+		// A board filled less than this fraction will use the SPARSE backend.
+		static const double SPARSE_FILL_RATIO;
+
+		// A dense raster with rows longer than this many times the xSize is copied
+		// instead of being used in place.
+		static const size_t MAX_PADDING_RATIO;
+
+		PointBoard();
+		PointBoard(const PointBoard &boardCopy);
+		PointBoard& operator = (const PointBoard &boardCopy);
+
+		// These assume that the locations were already checked to be within the domain
+		// and that the three vectors are the same size.  Non-finite values are not loaded.
+		void Load(const vector<size_t> &xLocs, const vector<size_t> &yLocs, const vector<float> &dataVals,
+			  const size_t &xSize, const size_t &ySize);
+		void Load(const Cluster &aClust, const size_t &xSize, const size_t &ySize);
+
+		// Loads cluster clustIndex of aSet, with (xOrigin, yOrigin) of the set's domain
+		// becoming (0, 0) of the board.
+		void Load(const ClusterSet &aSet, const size_t &clustIndex,
+			  const size_t &xOrigin, const size_t &yOrigin,
+			  const size_t &xSize, const size_t &ySize);
+
+		// Gridpoint (x, y) is at raster[(y * rowStride) + x].  Non-finite values are missing data.
+		void LoadRaster(const float *raster, const size_t &xSize, const size_t &ySize, const size_t &rowStride);
+
+		// Empties the board.  With keepMemory, the memory is kept for the next load,
+		// so that loading a board of the same size again doesn't allocate anything.
+		void Clear(const bool &keepMemory);
+
+		bool IsDense() const
+		{
+			return(myIsDense);
+		};
+
+		size_t SlotCount() const
+		{
+			return(myLabels.size());
+		};
+
+		// Slot offset from one row to the next, for a dense board.
+		size_t RowPitch() const
+		{
+			return(myRowPitch);
+		};
+
+		size_t FindSlot(const size_t &xLoc, const size_t &yLoc) const
+		{
+			if (myIsDense)
+			{
+				return((yLoc * myRowPitch) + xLoc);
+			}
+
+			const unordered_map<size_t, size_t>::const_iterator aSlot = mySlotLookup.find((yLoc * myXSize) + xLoc);
+			return(aSlot != mySlotLookup.end() ? aSlot->second : NO_SLOT);
+		};
+
+		size_t SlotX(const size_t &slot) const
+		{
+			return(myIsDense ? slot % myRowPitch : myGridIndices[slot] % myXSize);
+		};
+
+		size_t SlotY(const size_t &slot) const
+		{
+			return(myIsDense ? slot / myRowPitch : myGridIndices[slot] / myXSize);
+		};
+
+		float Value(const size_t &slot) const
+		{
+			return(myValueData[slot]);
+		};
+
+		PointLabel Label(const size_t &slot) const
+		{
+			return((PointLabel) myLabels[slot]);
+		};
+
+		void SetLabel(const size_t &slot, const PointLabel &newLabel)
+		{
+			myLabelCounts[myLabels[slot]]--;
+			myLabelCounts[newLabel]++;
+			myLabels[slot] = (unsigned char) newLabel;
+		};
+
+		// How many slots of the board currently have the given label, which for every label but UNINIT
+		// is how many gridpoints of the domain have it.  UNINIT counts the empty slots instead: none at all
+		// for a sparse board, and for a raster loaded in place, also the slots between the end
+		// of each row and the row stride.
+		// Kept up to date by SetLabel(), so this never needs to scan the board.
+		size_t LabelCount(const PointLabel &aLabel) const
+		{
+			return(myLabelCounts[aLabel]);
+		};
+
+		// Statistics of the values at the initialized gridpoints, in a single sweep of the board.
+		FieldStats Statistics() const;
+
+		// Marks are an O(1) "have I seen this slot yet?" test.  Starting a new
+		// generation of marks un-marks every slot without touching the whole board.
+		void StartMarking();
+
+		// Returns true if the slot was not already marked in this generation.
+		bool Mark(const size_t &slot)
+		{
+			if (myMarks[slot] == myMarkGeneration)
+			{
+				return(false);
+			}
+
+			myMarks[slot] = myMarkGeneration;
+			return(true);
+		};
+
+	private:
+		vector<float> myValues;
+		vector<unsigned char> myLabels;
+
+		// Either myValues.data(), or the caller's raster.
+		const float *myValueData;
+		size_t myRowPitch;
+
+		// Only used by the SPARSE backend.
+		vector<size_t> myGridIndices;			// row-major grid index of each slot
+		unordered_map<size_t, size_t> mySlotLookup;	// row-major grid index -> slot
+
+		size_t myLabelCounts[STRONG + 1];
+
+		// Scratch space for LoadPoints(), kept between loads.
+		vector<size_t> myLoadIndices;
+
+		vector<unsigned int> myMarks;
+		unsigned int myMarkGeneration;
+
+		size_t myXSize;
+		size_t myYSize;
+		bool myIsDense;
+
+		template <class PointSource> void LoadPoints(const PointSource &thePoints,
+							     const size_t &xSize, const size_t &ySize);
+		void CountLabels();
+};
+
+#endif
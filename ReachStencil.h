@@ -0,0 +1,51 @@
+#ifndef _REACHSTENCIL_H
+#define _REACHSTENCIL_H
+
+#include <vector>
+#include <cstddef>	// for size_t, ptrdiff_t
+
+
+// A ReachStencil is the list of neighbor offsets that lie within a given reach of a gridpoint,
+// not counting the gridpoint itself.  The offsets are kept in row-major order, which is the
+// same order that the original neighborhood loops visited them in.
+// It is computed once per board so that the neighborhood loops don't need to keep
+// recomputing the geometry for every gridpoint.
+class ReachStencil
+{
+	public:
+		struct Offset
+		{
+			int xOffset;
+			int yOffset;
+			double weight;		// 1 / distance, for distance-weighted counts.
+			ptrdiff_t slotOffset;	// xOffset + (yOffset * rowPitch), for a dense board.
+		};
+
+		ReachStencil();
+
+		// Keeps every offset where (reach > hypot(xOffset, yOffset)).
+		void Build(const float &reach, const size_t &rowPitch);
+		void Clear();
+
+		size_t size() const
+		{
+			return(myOffsets.size());
+		};
+
+		const Offset& operator [] (const size_t &index) const
+		{
+			return(myOffsets[index]);
+		};
+
+		// The largest |xOffset| or |yOffset| in the stencil.
+		int Extent() const
+		{
+			return(myExtent);
+		};
+
+	private:
+		vector<Offset> myOffsets;
+		int myExtent;
+};
+
+#endif
@@ -0,0 +1,90 @@
+#ifndef _STREAMANALYSIS_H
+#define _STREAMANALYSIS_H
+
+#include <vector>
+#include <functional>
+#include <mutex>
+#include <cstddef>	// for size_t
+
+#include "StrongPointAnalysis.h"
+#include "ClusterSet.h"
+#include "AnalysisObserver.h"
+
+
+// Clusters a sequence of frames that are all on the same grid, such as the scans of a radar
+// or the time steps of a model run, with the same parameters for every frame.
+//
+// Several frames are clustered at once, one for each thread of the shared WorkPool.  Each of
+// those "lanes" keeps its own analysis and output buffers from frame to frame, so once they have
+// grown large enough for the frames, clustering another frame doesn't allocate any memory
+// (except for frames sparse enough to need a sparse board).  Only as many frames as there are
+// lanes are ever in progress, which bounds the memory used, no matter how long the sequence is.
+//
+// Sub-clustering within a frame is done serially (see StrongPointAnalysis::SetParallelSubClustering()),
+// because the threads are already busy with other frames.
+class StreamAnalysis
+{
+	public:
+		// Returns the raster of frame frameIndex, laid out as for StrongPointAnalysis::LoadRaster().
+		// A NULL raster gives the frame no clusters.
+		typedef function<const float* (size_t frameIndex)> FrameSource;
+
+		// Receives the clusters of frame frameIndex.  The ClusterSet gets re-used for a later frame,
+		// so anything that is needed afterwards must be copied out of it.
+		typedef function<void (size_t frameIndex, const ClusterSet &theClusters)> FrameCallback;
+
+		StreamAnalysis(const size_t &xSize, const size_t &ySize, const size_t &rowStride,
+			       const float &upperSensitivity, const float &lowerSensitivity, const float &paddingLevel,
+			       const float &reach, const int &subClustDepth);
+
+		void SetExclusivePadding(const bool &isExclusive);
+
+		// Every lane reports to theObserver, so the lanes report from several threads at once.
+		void SetObserver(AnalysisObserver *theObserver);
+
+		// How many frames can be in progress at once.
+		size_t LaneCount() const;
+
+		// Clusters frames 0 ... frameCount - 1.  Each raster is fetched by getFrame() just before its
+		// frame gets clustered, and it must stay valid until frameDone() has returned for that frame.
+		// The frames finish in no particular order, and frameDone() is called as each one finishes.
+		// Neither getFrame() nor frameDone() is ever called by more than one thread at a time,
+		// and neither may throw.  Only one Run() at a time for each StreamAnalysis.
+		void Run(const size_t &frameCount, const FrameSource &getFrame, const FrameCallback &frameDone);
+
+		// For frames that are already in memory.
+		void Run(const vector<const float*> &theFrames, const FrameCallback &frameDone);
+
+	private:
+		struct Lane
+		{
+			Lane();
+
+			StrongPointAnalysis analysis;
+			ClusterSet clusters;
+		};
+
+		size_t myXSize;
+		size_t myYSize;
+		size_t myRowStride;
+
+		float myUpperSensitivity;
+		float myLowerSensitivity;
+		float myPaddingLevel;
+		float myReach;
+		int mySubClustDepth;
+
+		vector<Lane> myLanes;
+
+		mutex mySourceLock;	// held while picking and fetching the next frame
+		mutex myDoneLock;	// held while handing over a finished frame
+		size_t myNextFrame;
+
+		StreamAnalysis(const StreamAnalysis &streamCopy);		// not copyable
+		StreamAnalysis& operator = (const StreamAnalysis &streamCopy);
+
+		void RunLane(Lane &aLane, const size_t &frameCount,
+			     const FrameSource &getFrame, const FrameCallback &frameDone);
+};
+
+#endif
@@ -2,14 +2,21 @@
 #define _STRONGPOINTANALYSIS_H
 
 #include <vector>
-#include <cstddef>	// for size_t
+#include <utility>	// for pair
+#include <cstddef>	// for size_t, ptrdiff_t
+#include <stdint.h>	// for uint32_t
 
 #include "Cluster.h"
+#include "ClusterSet.h"
+#include "PointBoard.h"
+#include "FieldStats.h"
+#include "ReachStencil.h"
+#include "AnalysisObserver.h"
 
 
 class StrongPointAnalysis
 {
-	enum PointLabel { UNINIT = 0, UNCHECKED, IGNORABLE, WEAK, STRONG };
+	typedef PointBoard::PointLabel PointLabel;
 
 	class PointLoc
 	{
@@ -37,6 +44,21 @@ class StrongPointAnalysis
 		};
 	};
 
+	// One level of the strong point network search that is still in progress.
+	struct NetworkFrame
+	{
+		size_t slot;
+		size_t XLoc, YLoc;
+		size_t nextOffset;	// next entry in myReachStencil to try
+
+		// For a fixed stencil (see NetworkStrongPoints()), the neighbors that were still
+		// unchecked when the frame started, one bit for each entry of the stencil.
+		uint32_t candidates;
+	};
+
+	// The reach stencils that get a network search of their own (see FindStrongPoints()).
+	enum NetworkStencil { ANY_STENCIL = 0, NEIGHBOR_STENCIL, FIVE_BY_FIVE_STENCIL };
+
 	public:
 		StrongPointAnalysis();
 		StrongPointAnalysis(const vector<size_t> &xLocs, const vector<size_t> &yLocs, const vector<float> &dataVals,
@@ -51,6 +73,8 @@ class StrongPointAnalysis
 
 		void PrintBoard() const;
 
+		// The loads return false, and leave an empty board, for a domain that is wider or taller
+		// than ClusterSet::MAX_DOMAIN_SIZE, as well as for data that doesn't fit the domain.
 		bool LoadBoard(const Cluster &aClust, 
 			       const size_t &xSize, const size_t &ySize,
 			       const float &upperSensitivity, const float &lowerSensitivity, const float &paddingLevel,
@@ -61,12 +85,67 @@ class StrongPointAnalysis
 			       const float &upperSensitivity, const float &lowerSensitivity, const float &paddingLevel,
 			       const float &reach, const int &subClustDepth);
 
+		// Loads a row-major raster, where gridpoint (x, y) is at raster[(y * rowStride) + x]
+		// and non-finite values are treated as missing data.  Unless the raster is sparse enough
+		// to go on a sparse board, or its rows are much longer than xSize, the values are not copied,
+		// so the raster must stay valid until the analysis is done with it (the next load,
+		// or the end of the analysis).
+		bool LoadRaster(const float *raster, const size_t &xSize, const size_t &ySize, const size_t &rowStride,
+				const float &upperSensitivity, const float &lowerSensitivity, const float &paddingLevel,
+				const float &reach, const int &subClustDepth);
+
+		// For clustering a window of a bigger domain (see TiledAnalysis): loads the window of the
+		// raster like LoadRaster(), but the thresholds come from domainStats, the statistics of the
+		// whole domain, instead of from the window.  Those are the statistics that get reported.
+		bool LoadRasterWithThresholds(const float *raster, const size_t &xSize, const size_t &ySize, const size_t &rowStride,
+					      const float &upperSensitivity, const float &lowerSensitivity, const float &paddingLevel,
+					      const float &reach, const int &subClustDepth, const FieldStats &domainStats);
+
+		// The label that a point with this value gets when it is first checked: IGNORABLE at or below
+		// the weak threshold, STRONG at or above the strong threshold, and UNCHECKED in between,
+		// where it depends on the clusters around it.
+		PointBoard::PointLabel InitialLabel(const float &aVal) const;
+
 
 		vector<Cluster> DoCluster() const;
+
+		// The same clusters, in the compact layout.  Any previous contents of theClusters
+		// are replaced.  Use theClusters.FillLabelImage() for a label image of the domain.
+		void DoCluster(ClusterSet &theClusters) const;
+
+		// Clusters just the network of strong points that includes the gridpoint (XLoc, YLoc),
+		// with the sub-clustering done one cluster at a time.  The results are the same as DoCluster()
+		// gives for that network, as long as the board covers the network plus the extent of the reach
+		// on each side.  gridPointsUsed is for the whole domain, which may be bigger than the board,
+		// and clustIndex is which of the domain's clusters the network makes, for the reports.
+		// Any previous contents of theClusters are replaced.
+		void ClusterNetwork(const size_t &XLoc, const size_t &YLoc, const size_t &clustIndex,
+				    const size_t &gridPointsUsed, ClusterSet &theClusters) const;
+
+		// By default, a weak point may pad every cluster that it borders.  With exclusive padding,
+		// a weak point only goes to the first cluster that claims it.
+		void SetExclusivePadding(const bool &isExclusive);
+
+		// By default, the clusters of a board are sub-clustered concurrently on the shared WorkPool.
+		// Turning this off sub-clusters them one at a time, re-using the same sub-analysis
+		// and buffers for each cluster.  That is the better choice when the caller is
+		// already running several analyses at once (see StreamAnalysis).
+		void SetParallelSubClustering(const bool &isParallel);
+
+		// By default, each load (and each board that turns out to be unusable) releases the memory
+		// of the previous board and of the clustering buffers.  Keeping it instead means that,
+		// once the buffers have grown large enough, clustering another board of the same size
+		// doesn't allocate anything, at the cost of holding on to the largest board seen so far
+		// (see StreamAnalysis).  Sub-analyses follow the same setting.
+		void SetKeepMemory(const bool &keepMemory);
+
+		// Reports go to theObserver (see AnalysisObserver), which must stay around for as long
+		// as the analysis uses it.  NULL, the default, turns the reports off.
+		void SetObserver(AnalysisObserver *theObserver);
 		
 	private:
-		vector< vector< float > > myData;
-		mutable vector< vector< PointLabel > > myPointLabels;
+		// The point labels get updated while clustering, even by the const methods.
+		mutable PointBoard myBoard;
 
 		size_t myXSize;
 		size_t myYSize;
@@ -81,22 +160,65 @@ class StrongPointAnalysis
 		float myPaddingLevel;
 		int mySubClustDepth;
 
+		ReachStencil myReachStencil;	// neighbors within myReach
+		ReachStencil myTouchStencil;	// immediately surrounding neighbors
+		NetworkStencil myNetworkStencil;	// which fixed stencil myReachStencil is, if any
+
+		// Kept between calls so that the network search doesn't re-allocate for each cluster.
+		mutable vector<NetworkFrame> myWorklist;
+
+		// Kept between calls so that padding doesn't re-allocate for each cluster.
+		mutable vector<size_t> myStrongSlots;
+		mutable vector< pair<PointLoc, size_t> > myClustDomain;
+
+		// The networked clusters, and the clusters after padding.
+		mutable ClusterSet myNetworkSet;
+		mutable ClusterSet myPaddedSet;
+
+		// For exclusive padding, the ID of the cluster that each weak point was padded into (0 for none).
+		mutable vector<unsigned int> myOwners;
+		bool myExclusivePadding;
+
+		// For serial sub-clustering, the re-used sub-analysis (created on first use) and its results.
+		bool myParallelSubClustering;
+		bool myKeepMemory;
+		mutable vector<StrongPointAnalysis> mySubAnalysis;
+		mutable ClusterSet mySubClusterSet;
+
+		// Where the reports go, and the sub-clustering level of this analysis.  Not changed by ResetBoard().
+		AnalysisObserver *myObserver;
+		int myLevel;
+
 
-		bool IsStrongPoint(const size_t &xLoc, const size_t &yLoc) const;
-		bool IsWeakPoint(const size_t &xLoc, const size_t &yLoc) const;
-		bool IsIgnorablePoint(const size_t &xLoc, const size_t &yLoc) const;
-		bool BeenChecked(const size_t &xLoc, const size_t &yLoc) const;
-		bool IsUninitialized(const size_t &xLoc, const size_t &yLoc) const;
+		bool IsStrongPoint(const size_t &slot) const;
+		bool IsWeakPoint(const size_t &slot) const;
+		bool IsIgnorablePoint(const size_t &slot) const;
+		bool BeenChecked(const size_t &slot) const;
+		bool IsUninitialized(const size_t &slot) const;
 
-		void FindStrongPoints(const size_t &Xindex, const size_t &Yindex, Cluster &newCluster) const;
-		void PadCluster(Cluster &baseCluster) const;
-		vector<Cluster> SubCluster(const Cluster &origCluster) const;
+		void FindStrongPoints(const size_t &slot, ClusterSet &theClusters) const;
+		template <class FixedStencil> void NetworkStrongPoints(const size_t &slot, ClusterSet &theClusters) const;
+		size_t NeighborSlot(const size_t &slot, const size_t &XLoc, const size_t &YLoc,
+				    const ReachStencil::Offset &anOffset, const bool &isInterior) const;
+		void PadCluster(const ClusterSet &strongSet, const size_t &clustIndex, ClusterSet &paddedSet) const;
+		bool CanSubCluster(const size_t &memberCount, const size_t &gridPointsUsed) const;
+		void SubCluster(const ClusterSet &origSet, const size_t &clustIndex, const size_t &reportIndex,
+				const size_t &gridPointsUsed, ClusterSet &subClusters,
+				StrongPointAnalysis &newSPA, ClusterSet &newClusters) const;
 
 		void AnalyzeBoard();
+		void SetThresholds(const FieldStats &boardStats);
+		void ReportLabels() const;
+		void SetParameters(const size_t &xSize, const size_t &ySize,
+				   const float &upperSensitivity, const float &lowerSensitivity, const float &paddingLevel,
+				   const float &reach, const int &subClustDepth);
 		bool LoadData(const vector<size_t> &xLocs, const vector<size_t> &yLocs, const vector<float> &dataVals);
+		bool LoadData(const Cluster &aCluster);
+		bool LoadData(const ClusterSet &aSet, const size_t &clustIndex, const size_t &xOrigin, const size_t &yOrigin);
+		void BuildStencils();
 		void ResetBoard();
 
-		double StrongPointsTouch(const size_t &XLoc, const size_t &YLoc) const;
+		double StrongPointsTouch(const size_t &slot) const;
 		size_t GridSize() const;
 		size_t GridPointsUsed() const;
 };
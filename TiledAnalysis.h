@@ -0,0 +1,143 @@
+#ifndef _TILEDANALYSIS_H
+#define _TILEDANALYSIS_H
+
+#include <vector>
+#include <string>
+#include <utility>	// for pair
+#include <cstddef>	// for size_t
+#include <stdint.h>	// for uint32_t
+
+#include "StrongPointAnalysis.h"
+#include "PointBoard.h"
+#include "ClusterSet.h"
+#include "FieldStats.h"
+#include "ReachStencil.h"
+#include "AnalysisObserver.h"
+
+
+// Clusters a big domain, such as a raster file that is larger than memory.  The raster is
+// memory-mapped, so only the parts being worked on need to be resident, and the strong points
+// are found a tile at a time, with the tiles done concurrently.
+//
+// It finds the same clusters, in the same order, as StrongPointAnalysis::LoadRaster() and
+// DoCluster() would for the whole raster:
+//   1. The statistics of the whole raster are gathered, for the thresholds.
+//   2. Each tile finds its strong points, and networks them within the tile.  A strong point
+//      within reach of a strong point in a neighboring tile (in the tile's halo) makes a seam.
+//      The networks that stay within the tile are done there.  The rest get joined up across
+//      the seams with a union-find over just the parts of them that are in each tile.
+//   3. Each network is then clustered on a board that just covers it and its halo, several at
+//      a time, and their clusters get added on in order as each round of them finishes.
+//
+// Besides the raster and the clusters that come back, the memory it takes is:
+//   - 4 bytes per gridpoint, and about 16 per strong point, of each tile being worked on,
+//     with as many tiles at once as the shared WorkPool has threads;
+//   - 24 bytes per network of the domain, 16 per strong point on a seam, and 16 per pair of
+//     strong points that reach each other across a seam;
+//   - whatever StrongPointAnalysis takes to cluster a board the size of each network's bounding box
+//     plus its halo, again for as many networks at once as there are threads, along with the clusters
+//     of up to 64 networks that are waiting for their turn to be added on.
+// So the tiles save memory when the networks are small compared to the domain.  A network that
+// spans most of the domain puts most of the domain on one board, and clustering it takes about
+// as much memory as StrongPointAnalysis::LoadRaster() and DoCluster() would for the whole raster.
+//
+// Exclusive padding is not available, because it depends on the order that all of the
+// clusters of the domain get padded in.
+class TiledAnalysis
+{
+	public:
+		TiledAnalysis();
+		~TiledAnalysis();
+
+		// Maps a file of xSize * ySize native-endian 32-bit floats, in row-major order.
+		// Non-finite values are missing data.  Returns false if the file can't be mapped,
+		// if it is too small, or if the parameters don't make sense (including a domain that is
+		// wider or taller than ClusterSet::MAX_DOMAIN_SIZE).
+		bool LoadRaster(const string &fileName, const size_t &xSize, const size_t &ySize,
+				const float &upperSensitivity, const float &lowerSensitivity, const float &paddingLevel,
+				const float &reach, const int &subClustDepth);
+
+		// The same, but for a raster that the caller already has in memory (or mapped).
+		// The raster must stay valid for as long as it is loaded.
+		bool LoadRaster(const float *raster, const size_t &xSize, const size_t &ySize,
+				const float &upperSensitivity, const float &lowerSensitivity, const float &paddingLevel,
+				const float &reach, const int &subClustDepth);
+
+		// The width and height of a tile, not counting its halo.  Defaults to 1024,
+		// and can't be more than MAX_TILE_SIZE.
+		static const size_t MAX_TILE_SIZE;
+		void SetTileSize(const size_t &tileSize);
+
+		// Reports go to theObserver, as for StrongPointAnalysis::SetObserver().  The tiles and the
+		// networks are reported as parts of level 0, with the same point counts and cluster indices
+		// as for the whole raster.  The NETWORKING phase gets reported once for the tiles and seams, and
+		// then again, along with PADDING, for each network.  The networks are clustered concurrently,
+		// so the observer must be thread-safe.
+		void SetObserver(AnalysisObserver *theObserver);
+
+		// Any previous contents of theClusters are replaced.
+		void DoCluster(ClusterSet &theClusters) const;
+
+	private:
+		// A network of strong points, or the part of one that is in a tile.
+		struct Network
+		{
+			size_t firstIndex;		// smallest row-major grid index
+			uint32_t minX, maxX;
+			uint32_t minY, maxY;
+		};
+
+		// What each tile finds in step 2.
+		struct TileResults
+		{
+			vector<Network> networks;	// the networks that stay within the tile
+			vector<Network> seamNetworks;	// the tile's parts of the networks that cross a seam
+
+			// The strong points of the tile that are within reach of a strong point in another tile,
+			// as (row-major grid index, position in seamNetworks), in grid index order.
+			vector< pair<size_t, uint32_t> > seamPoints;
+
+			// Seams that reach across to a strong point with a larger grid index in another tile,
+			// as (position in seamNetworks, grid index in the other tile).
+			vector< pair<uint32_t, size_t> > seams;
+
+			size_t strongCount;
+			size_t ignorableCount;
+			size_t unpaddedCount;		// points between the thresholds that no strong point reaches
+		};
+
+		const float *myRaster;
+		void *myMapping;
+		size_t myMappingSize;
+
+		size_t myXSize;
+		size_t myYSize;
+		size_t myTileSize;
+
+		float myUpperSensitivity;
+		float myLowerSensitivity;
+		float myPaddingLevel;
+		float myReach;
+		int mySubClustDepth;
+		ReachStencil myReachStencil;
+
+		// Has the thresholds for the whole domain, on a board of just the first row of the raster.
+		StrongPointAnalysis myDomainAnalysis;
+		FieldStats myRasterStats;
+
+		AnalysisObserver *myObserver;
+
+		TiledAnalysis(const TiledAnalysis &tiledCopy);		// not copyable
+		TiledAnalysis& operator = (const TiledAnalysis &tiledCopy);
+
+		void Unload();
+		void RasterStatistics();
+		PointBoard::PointLabel RasterLabel(const size_t &gridIndex) const;
+
+		void FindTileNetworks(const size_t &tileIndex, TileResults &theResults) const;
+		void FindNetworks(vector<Network> &theNetworks, vector<size_t> &labelCounts) const;
+		void ClusterNetwork(const Network &aNetwork, const size_t &networkIndex, const size_t &gridPointsUsed,
+				    ClusterSet &theClusters) const;
+};
+
+#endif
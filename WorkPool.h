@@ -0,0 +1,79 @@
+#ifndef _WORKPOOL_H
+#define _WORKPOOL_H
+
+#include <vector>
+#include <deque>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <exception>	// for exception_ptr
+#include <cstddef>	// for size_t
+
+
+// A small work-stealing thread pool.
+// Each worker thread has its own queue of tasks.  A worker runs the newest task from its
+// own queue first, and steals the oldest task from another queue when its own is empty.
+// The thread that calls RunTasks() also runs tasks while it waits, so RunTasks() may
+// be called again from inside of a task without tying up the pool.  Once there is nothing
+// left for it to run, it sleeps until the rest of its tasks are done.
+class WorkPool
+{
+	public:
+		explicit WorkPool(const size_t &workerCount);
+		~WorkPool();
+
+		// A pool shared by the whole process, with a worker for every extra hardware thread.
+		static WorkPool& Shared();
+
+		size_t WorkerCount() const;
+
+		// Calls task(0) ... task(taskCount - 1), in no particular order, and returns
+		// once all of them have finished.  If any of them throws, the rest still get run,
+		// and then the first exception is thrown again from here.
+		void RunTasks(const size_t &taskCount, const function<void (size_t)> &task);
+
+	private:
+		struct TaskBatch
+		{
+			const function<void (size_t)> *task;
+
+			// Held while a task of the batch finishes, and while the caller checks on them.
+			mutex doneLock;
+			condition_variable doneSignal;
+			size_t pending;
+			exception_ptr firstError;
+		};
+
+		struct Task
+		{
+			TaskBatch *batch;
+			size_t index;
+		};
+
+		struct TaskQueue
+		{
+			mutex lock;
+			deque<Task> tasks;
+		};
+
+		// One queue for each worker, plus one more for the threads outside of the pool.
+		vector<TaskQueue> myQueues;
+		vector<thread> myWorkers;
+
+		mutex mySleepLock;
+		condition_variable mySleepSignal;
+		atomic<size_t> myQueuedCount;
+		bool myIsStopping;
+
+		WorkPool(const WorkPool &poolCopy);		// not copyable
+		WorkPool& operator = (const WorkPool &poolCopy);
+
+		void WorkerLoop(const size_t &queueIndex);
+		bool PopTask(const size_t &homeQueue, Task &aTask);
+		void RunTask(const Task &aTask);
+		size_t HomeQueue() const;
+};
+
+#endif